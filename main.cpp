@@ -9,6 +9,9 @@
 #include <iomanip>
 #include <cctype>
 #include <chrono>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
 
 using namespace std;
 namespace fs = filesystem;
@@ -29,6 +32,11 @@ struct CompressorStation {
     int stationClass;
 };
 
+double calculateInactivePercent(const CompressorStation& station) {
+    return station.totalWorkshops > 0 ?
+           100.0 * (station.totalWorkshops - station.activeWorkshops) / station.totalWorkshops : 0.0;
+}
+
 class Logger {
 private:
     mutable ofstream logFile;
@@ -139,6 +147,348 @@ public:
     }
 };
 
+enum class ColumnType : uint8_t {
+    Int32 = 1,
+    Float64 = 2,
+    Bool = 3,
+    String = 4
+};
+
+struct ColumnSpec {
+    string name;
+    ColumnType type;
+};
+
+// Хранимое поле записи: имя колонки, указатель на член и оформление при выводе на экран.
+template <typename Record, typename T>
+struct Field {
+    const char* name;
+    T Record::* member;
+    const char* prefix;
+    const char* suffix;
+    int precision;
+
+    const T& get(const Record& record) const { return record.*member; }
+};
+
+// Вычисляемое значение: выводится на экран, но не сохраняется и не экспортируется.
+template <typename Record, typename T>
+struct ComputedField {
+    T (*compute)(const Record&);
+    const char* prefix;
+    const char* suffix;
+    int precision;
+
+    T get(const Record& record) const { return compute(record); }
+};
+
+template <typename Record, typename T>
+constexpr Field<Record, T> field(const char* name, T Record::* member, const char* prefix,
+                                 const char* suffix = "", int precision = -1) {
+    return {name, member, prefix, suffix, precision};
+}
+
+template <typename Record, typename T>
+constexpr ComputedField<Record, T> computed(T (*compute)(const Record&), const char* prefix,
+                                            const char* suffix = "", int precision = -1) {
+    return {compute, prefix, suffix, precision};
+}
+
+// Схема записи задаётся один раз; сохранение, загрузка, вывод и экспорт
+// разворачиваются из неё на этапе компиляции. Новое поле добавляется только здесь.
+template <typename Record>
+struct RecordSchema;
+
+template <>
+struct RecordSchema<Pipe> {
+    static constexpr auto fields = make_tuple(
+        field("id", &Pipe::id, "ID: "),
+        field("name", &Pipe::name, " | "),
+        field("length", &Pipe::length, ", Длина: ", " км"),
+        field("diameter", &Pipe::diameter, ", Диаметр: ", " мм"),
+        field("under_repair", &Pipe::underRepair, ", В ремонте: ")
+    );
+};
+
+template <>
+struct RecordSchema<CompressorStation> {
+    static constexpr auto fields = make_tuple(
+        field("id", &CompressorStation::id, "ID: "),
+        field("name", &CompressorStation::name, " | "),
+        field("total_workshops", &CompressorStation::totalWorkshops, ", Цехов: "),
+        field("active_workshops", &CompressorStation::activeWorkshops, ", Работает: "),
+        computed(calculateInactivePercent, ", Незадействовано: ", "%", 1),
+        field("station_class", &CompressorStation::stationClass, ", Класс: ")
+    );
+};
+
+class RecordSerializer {
+private:
+    template <typename T>
+    static constexpr ColumnType columnTypeOf() {
+        if constexpr (is_same_v<T, bool>) return ColumnType::Bool;
+        else if constexpr (is_same_v<T, int>) return ColumnType::Int32;
+        else if constexpr (is_same_v<T, double>) return ColumnType::Float64;
+        else {
+            static_assert(is_same_v<T, string>, "Неподдерживаемый тип поля");
+            return ColumnType::String;
+        }
+    }
+
+    template <typename Visitor, typename Record, typename T>
+    static void visitStored(Visitor& visit, const Field<Record, T>& field) { visit(field); }
+
+    template <typename Visitor, typename Record, typename T>
+    static void visitStored(Visitor&, const ComputedField<Record, T>&) {}
+
+    template <typename Record, typename Visitor>
+    static void forEachStoredField(Visitor&& visit) {
+        apply([&](const auto&... fields) { (visitStored(visit, fields), ...); },
+              RecordSchema<Record>::fields);
+    }
+
+    template <typename Record, typename Visitor>
+    static void forEachField(Visitor&& visit) {
+        apply([&](const auto&... fields) { (visit(fields), ...); }, RecordSchema<Record>::fields);
+    }
+
+    template <typename T>
+    static void displayValue(ostream& out, const T& value, int precision) {
+        if constexpr (is_same_v<T, bool>) {
+            out << (value ? "Да" : "Нет");
+        } else if (precision >= 0) {
+            ios::fmtflags flags = out.flags();
+            streamsize oldPrecision = out.precision();
+            out << fixed << setprecision(precision) << value;
+            out.flags(flags);
+            out.precision(oldPrecision);
+        } else {
+            out << value;
+        }
+    }
+
+public:
+    template <typename Record>
+    static const vector<ColumnSpec>& columns() {
+        static const vector<ColumnSpec> result = [] {
+            vector<ColumnSpec> specs;
+            forEachStoredField<Record>([&](const auto& field) {
+                using T = decay_t<decltype(field.get(declval<const Record&>()))>;
+                specs.push_back({field.name, columnTypeOf<T>()});
+            });
+            return specs;
+        }();
+        return result;
+    }
+
+    // Текстовый формат: одно значение на строку, в порядке полей схемы.
+    template <typename Record>
+    static void writeText(ostream& out, const Record& record) {
+        forEachStoredField<Record>([&](const auto& field) {
+            out << field.get(record) << '\n';
+        });
+    }
+
+    template <typename Record>
+    static void readText(istream& in, Record& record) {
+        bool pendingNewline = false;
+        forEachStoredField<Record>([&](const auto& field) {
+            auto& value = record.*field.member;
+            if constexpr (is_same_v<decay_t<decltype(value)>, string>) {
+                if (pendingNewline) in.ignore();
+                getline(in, value);
+                pendingNewline = false;
+            } else {
+                in >> value;
+                pendingNewline = true;
+            }
+        });
+        if (pendingNewline) in.ignore();
+    }
+
+    template <typename Record, typename Writer>
+    static void writeRow(Writer& writer, const Record& record) {
+        forEachStoredField<Record>([&](const auto& field) {
+            writer.writeField(field.get(record));
+        });
+        writer.endRow();
+    }
+
+    template <typename Record>
+    static void display(ostream& out, const Record& record) {
+        forEachField<Record>([&](const auto& field) {
+            out << field.prefix;
+            displayValue(out, field.get(record), field.precision);
+            out << field.suffix;
+        });
+        out << endl;
+    }
+};
+
+// Построчная запись в CSV: каждая строка сразу уходит в поток, память не растёт.
+class CsvWriter {
+private:
+    ofstream file;
+    bool rowStarted = false;
+
+    static string escape(const string& value) {
+        if (value.find_first_of(",\"\r\n") == string::npos) {
+            return value;
+        }
+        string result = "\"";
+        for (char c : value) {
+            if (c == '"') result += '"';
+            result += c;
+        }
+        result += '"';
+        return result;
+    }
+
+    void separator() {
+        if (rowStarted) file << ',';
+        rowStarted = true;
+    }
+
+public:
+    CsvWriter(const string& filename, const vector<ColumnSpec>& columns) : file(filename) {
+        if (!file.is_open()) return;
+        file << setprecision(numeric_limits<double>::max_digits10);
+        for (const auto& column : columns) {
+            separator();
+            file << escape(column.name);
+        }
+        endRow();
+    }
+
+    bool isOpen() const { return file.is_open(); }
+
+    void writeField(int value) { separator(); file << value; }
+    void writeField(double value) { separator(); file << value; }
+    void writeField(bool value) { separator(); file << (value ? 1 : 0); }
+    void writeField(const string& value) { separator(); file << escape(value); }
+
+    void endRow() {
+        file << '\n';
+        rowStarted = false;
+    }
+
+    bool close() {
+        file.close();
+        return !file.fail();
+    }
+};
+
+// Колоночный бинарный формат (PLCOL). Строки копятся в группы по rowGroupSize,
+// после чего каждая колонка группы пишется в файл одним непрерывным блоком.
+// Значения пишутся как есть, в порядке байт платформы; сборка для big-endian
+// запрещена ниже, поэтому файл всегда little-endian.
+// Раскладка:
+//   "PLCOL1\0\0", uint32 число колонок, на каждую: uint8 тип, uint32 длина имени, имя
+//   группы: uint32 число строк, на каждую колонку: uint64 размер блока, блок
+//     (для String блок = uint32 смещения [строк + 1], затем байты строк)
+//   uint32 0 как конец групп, uint64 всего строк, uint32 число групп, "PLCOL1\0\0"
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "ColumnarWriter пишет значения в порядке байт платформы и поддерживает только little-endian"
+#endif
+class ColumnarWriter {
+private:
+    static constexpr size_t rowGroupSize = 8192;
+    static constexpr char magic[8] = {'P', 'L', 'C', 'O', 'L', '1', '\0', '\0'};
+
+    ofstream file;
+    vector<ColumnSpec> columns;
+    vector<string> data;
+    vector<vector<uint32_t>> offsets;
+    size_t currentColumn = 0;
+    size_t bufferedRows = 0;
+    uint64_t totalRows = 0;
+    uint32_t rowGroups = 0;
+
+    template <typename T>
+    static void appendRaw(string& buffer, T value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    void writeRaw(T value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    string& nextColumn() {
+        return data[currentColumn++];
+    }
+
+    void flushRowGroup() {
+        if (bufferedRows == 0) return;
+
+        writeRaw(static_cast<uint32_t>(bufferedRows));
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (columns[i].type == ColumnType::String) {
+                uint64_t offsetsSize = offsets[i].size() * sizeof(uint32_t);
+                writeRaw(static_cast<uint64_t>(offsetsSize + data[i].size()));
+                file.write(reinterpret_cast<const char*>(offsets[i].data()), offsetsSize);
+                offsets[i].assign(1, 0);
+            } else {
+                writeRaw(static_cast<uint64_t>(data[i].size()));
+            }
+            file.write(data[i].data(), data[i].size());
+            data[i].clear();
+        }
+
+        totalRows += bufferedRows;
+        rowGroups++;
+        bufferedRows = 0;
+    }
+
+public:
+    ColumnarWriter(const string& filename, const vector<ColumnSpec>& columns)
+        : file(filename, ios::binary), columns(columns), data(columns.size()),
+          offsets(columns.size(), vector<uint32_t>(1, 0)) {
+        if (!file.is_open()) return;
+        file.write(magic, sizeof(magic));
+        writeRaw(static_cast<uint32_t>(columns.size()));
+        for (const auto& column : columns) {
+            writeRaw(static_cast<uint8_t>(column.type));
+            writeRaw(static_cast<uint32_t>(column.name.size()));
+            file.write(column.name.data(), column.name.size());
+        }
+    }
+
+    ~ColumnarWriter() {
+        close();
+    }
+
+    bool isOpen() const { return file.is_open(); }
+
+    void writeField(int value) { appendRaw(nextColumn(), static_cast<int32_t>(value)); }
+    void writeField(double value) { appendRaw(nextColumn(), value); }
+    void writeField(bool value) { appendRaw(nextColumn(), static_cast<uint8_t>(value)); }
+
+    void writeField(const string& value) {
+        size_t column = currentColumn;
+        nextColumn().append(value);
+        offsets[column].push_back(static_cast<uint32_t>(data[column].size()));
+    }
+
+    void endRow() {
+        currentColumn = 0;
+        if (++bufferedRows == rowGroupSize) {
+            flushRowGroup();
+        }
+    }
+
+    bool close() {
+        if (!file.is_open()) return !file.fail();
+        flushRowGroup();
+        writeRaw(static_cast<uint32_t>(0));
+        writeRaw(totalRows);
+        writeRaw(rowGroups);
+        file.write(magic, sizeof(magic));
+        file.close();
+        return !file.fail();
+    }
+};
+
 class PipelineSystem {
 private:
     vector<Pipe> pipes;
@@ -212,6 +562,15 @@ private:
         return ids;
     }
 
+    static vector<int> allIndices(size_t count) {
+        vector<int> indices;
+        indices.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            indices.push_back(static_cast<int>(i));
+        }
+        return indices;
+    }
+
     vector<int> getStationIds() const {
         vector<int> ids;
         for (const auto& station : stations) {
@@ -226,11 +585,6 @@ private:
         return result;
     }
 
-    double calculateInactivePercent(const CompressorStation& station) const {
-        return station.totalWorkshops > 0 ?
-               100.0 * (station.totalWorkshops - station.activeWorkshops) / station.totalWorkshops : 0.0;
-    }
-
     vector<int> findPipesByName(const string& searchName) const {
         vector<int> result;
         string searchLower = toLower(searchName);
@@ -293,28 +647,79 @@ private:
         if (!pipeIndices.empty()) {
             cout << "\nТрубы (" << pipeIndices.size() << ")\n";
             for (int index : pipeIndices) {
-                const Pipe& pipe = pipes[index];
-                cout << "ID: " << pipe.id << " | " << pipe.name
-                     << ", Длина: " << pipe.length << " км"
-                     << ", Диаметр: " << pipe.diameter << " мм"
-                     << ", В ремонте: " << (pipe.underRepair ? "Да" : "Нет") << endl;
+                RecordSerializer::display(cout, pipes[index]);
             }
         }
 
         if (!stationIndices.empty()) {
             cout << "\nКС (" << stationIndices.size() << ")\n";
             for (int index : stationIndices) {
-                const CompressorStation& station = stations[index];
-                double inactivePercent = calculateInactivePercent(station);
-                cout << "ID: " << station.id << " | " << station.name
-                     << ", Цехов: " << station.totalWorkshops
-                     << ", Работает: " << station.activeWorkshops
-                     << fixed << setprecision(1) << ", Незадействовано: " << inactivePercent << "%"
-                     << ", Класс: " << station.stationClass << endl;
+                RecordSerializer::display(cout, stations[index]);
             }
         }
     }
 
+    template <typename Writer, typename Record>
+    static bool exportRecords(const string& filename, const vector<Record>& records, const vector<int>& indices) {
+        Writer writer(filename, RecordSerializer::columns<Record>());
+        if (!writer.isOpen()) {
+            cout << "Ошибка: невозможно создать файл " << filename << endl;
+            return false;
+        }
+        for (int index : indices) {
+            RecordSerializer::writeRow(writer, records[index]);
+        }
+        if (!writer.close()) {
+            cout << "Ошибка: не удалось записать файл " << filename << endl;
+            return false;
+        }
+        return true;
+    }
+
+    template <typename Writer>
+    bool exportFiles(const string& baseName, const string& extension,
+                     const vector<int>& pipeIndices, const vector<int>& stationIndices) const {
+        if (!pipeIndices.empty()) {
+            string filename = baseName + "_pipes" + extension;
+            if (!exportRecords<Writer>(filename, pipes, pipeIndices)) return false;
+            cout << "Трубы экспортированы в файл: " << fs::absolute(filename) << endl;
+        }
+
+        if (!stationIndices.empty()) {
+            string filename = baseName + "_stations" + extension;
+            if (!exportRecords<Writer>(filename, stations, stationIndices)) return false;
+            cout << "КС экспортированы в файл: " << fs::absolute(filename) << endl;
+        }
+        return true;
+    }
+
+    void exportObjects(const vector<int>& pipeIndices, const vector<int>& stationIndices) {
+        if (pipeIndices.empty() && stationIndices.empty()) {
+            cout << "Нет объектов для экспорта.\n";
+            return;
+        }
+
+        cout << "1. CSV\n2. Колоночный бинарный формат (.plcol)\n";
+        int format = InputValidator::getIntInput("Выберите формат экспорта: ", 1, 2);
+        string baseName = InputValidator::getStringInput("Введите имя файла для экспорта (без расширения): ");
+
+        bool success = format == 1 ?
+            exportFiles<CsvWriter>(baseName, ".csv", pipeIndices, stationIndices) :
+            exportFiles<ColumnarWriter>(baseName, ".plcol", pipeIndices, stationIndices);
+
+        if (success) {
+            logger.log("Экспорт данных", "Файл: " + baseName + ", Формат: " + (format == 1 ? "CSV" : "PLCOL") +
+                       ", Трубы: " + to_string(pipeIndices.size()) + ", КС: " + to_string(stationIndices.size()));
+        }
+    }
+
+    void offerExport(const vector<int>& pipeIndices, const vector<int>& stationIndices) {
+        if (pipeIndices.empty() && stationIndices.empty()) return;
+        if (InputValidator::getIntInput("Экспортировать результаты? (1 - да, 0 - нет): ", 0, 1) == 1) {
+            exportObjects(pipeIndices, stationIndices);
+        }
+    }
+
 public:
     void addPipe() {
         Pipe newPipe;
@@ -491,6 +896,7 @@ public:
         
         displayObjects(results, {});
         logger.log("Поиск труб", searchDetails + ", Найдено: " + to_string(results.size()));
+        offerExport(results, {});
     }
 
     void searchStations() {
@@ -523,13 +929,15 @@ public:
         
         displayObjects({}, results);
         logger.log("Поиск КС", searchDetails + ", Найдено: " + to_string(results.size()));
+        offerExport({}, results);
     }
 
     void viewAll() const {
-        vector<int> allPipeIndices, allStationIndices;
-        for (int i = 0; i < pipes.size(); ++i) allPipeIndices.push_back(i);
-        for (int i = 0; i < stations.size(); ++i) allStationIndices.push_back(i);
-        displayObjects(allPipeIndices, allStationIndices);
+        displayObjects(allIndices(pipes.size()), allIndices(stations.size()));
+    }
+
+    void exportAll() {
+        exportObjects(allIndices(pipes.size()), allIndices(stations.size()));
     }
 
     void saveData() {
@@ -549,14 +957,12 @@ public:
         
         file << "PIPES " << pipes.size() << endl;
         for (const auto& pipe : pipes) {
-            file << pipe.id << endl << pipe.name << endl << pipe.length << endl
-                 << pipe.diameter << endl << pipe.underRepair << endl;
+            RecordSerializer::writeText(file, pipe);
         }
         
         file << "STATIONS " << stations.size() << endl;
         for (const auto& station : stations) {
-            file << station.id << endl << station.name << endl << station.totalWorkshops << endl
-                 << station.activeWorkshops << endl << station.stationClass << endl;
+            RecordSerializer::writeText(file, station);
         }
         
         file.close();
@@ -597,11 +1003,7 @@ public:
         
         for (size_t i = 0; i < count; ++i) {
             Pipe pipe;
-            file >> pipe.id;
-            file.ignore();
-            getline(file, pipe.name);
-            file >> pipe.length >> pipe.diameter >> pipe.underRepair;
-            file.ignore();
+            RecordSerializer::readText(file, pipe);
             pipes.push_back(pipe);
         }
         
@@ -614,11 +1016,7 @@ public:
         
         for (size_t i = 0; i < count; ++i) {
             CompressorStation station;
-            file >> station.id;
-            file.ignore();
-            getline(file, station.name);
-            file >> station.totalWorkshops >> station.activeWorkshops >> station.stationClass;
-            file.ignore();
+            RecordSerializer::readText(file, station);
             
             if (station.activeWorkshops > station.totalWorkshops) {
                 station.activeWorkshops = station.totalWorkshops;
@@ -641,9 +1039,10 @@ public:
                  << "1. Добавить трубу\n2. Добавить КС\n3. Добавить несколько труб\n4. Добавить несколько КС\n"
                  << "5. Просмотр всех объектов\n6. Редактировать трубу\n7. Редактировать КС\n"
                  << "8. Удалить трубу\n9. Удалить КС\n10. Удалить несколько труб\n11. Удалить несколько КС\n"
-                 << "12. Поиск труб\n13. Поиск КС\n14. Сохранить данные\n15. Загрузить данные\n0. Выход\n";
+                 << "12. Поиск труб\n13. Поиск КС\n14. Сохранить данные\n15. Загрузить данные\n"
+                 << "16. Экспорт данных\n0. Выход\n";
             
-            int choice = InputValidator::getIntInput("Выберите действие: ", 0, 15);
+            int choice = InputValidator::getIntInput("Выберите действие: ", 0, 16);
             logger.log("Выбор меню", "Действие: " + to_string(choice));
             
             switch (choice) {
@@ -662,6 +1061,7 @@ public:
                 case 13: searchStations(); break;
                 case 14: saveData(); break;
                 case 15: loadData(); break;
+                case 16: exportAll(); break;
                 case 0:
                     cout << "Выход из программы.\n";
                     logger.log("Выход из программы");